@@ -3,10 +3,17 @@
 #include <vector>
 #include <memory>
 #include <algorithm>
+#include <iterator>
+#include <utility>
 #include <string>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
 
 #include "FwdDecl.h"
-#include "ItemIndexPair.h"
+#include "Arena.h"
+#include "SymbolTable.h"
+#include "GenerationalHandle.h"
 #include "Vertex.h"
 #include "Edge.h"
 #include "Kruskal.h"
@@ -15,13 +22,83 @@ class AdjacencyList
 {
 public:
     typedef Vertex vertex_type;
+    typedef InternedVertex interned_vertex_type;
     typedef std::string vertex_id_type;
-    typedef std::vector<std::shared_ptr<vertex_type>> vertex_container;
-    typedef ItemIndexPair<vertex_type> vertex_pointer;
+    typedef Arena<interned_vertex_type> vertex_container;
+    typedef GenerationalHandle<interned_vertex_type> vertex_pointer;
     
     typedef Edge<vertex_pointer> edge_type;
-    typedef std::vector<std::shared_ptr<edge_type>> edge_container;
-    typedef ItemIndexPair<edge_type> edge_pointer;
+    typedef Arena<edge_type> edge_container;
+    typedef GenerationalHandle<edge_type> edge_pointer;
+
+    AdjacencyList()
+        : m_ownedSymbols(std::make_shared<SymbolTable>())
+        , m_symbols(m_ownedSymbols)
+    {
+
+    }
+
+    // Graphs sharing a symbol table can exchange vertices without reinterning
+    // their ids. The table is only read; the first id it does not already
+    // contain makes this graph switch to a private copy.
+    explicit AdjacencyList(std::shared_ptr<const SymbolTable> symbols)
+        : m_symbols(std::move(symbols))
+    {
+
+    }
+
+    // Copies share the source's symbol table in the same way as edgeSubgraph. Handles
+    // into the source stay tied to the source; the copy's elements have the same indices.
+    AdjacencyList(const AdjacencyList& other)
+        : m_symbols(other.m_symbols)
+        , m_vertexBySymbol(other.m_vertexBySymbol)
+    {
+        for (size_t vertexIdx = 0; vertexIdx < other.m_vertices.size(); ++vertexIdx)
+        {
+            insertSlot(m_vertexSlots, m_vertices.create(other.m_vertices[vertexIdx]));
+        }
+
+        for (size_t edgeIdx = 0; edgeIdx < other.m_edges.size(); ++edgeIdx)
+        {
+            const auto& edge(other.m_edges[edgeIdx]);
+            appendEdge(makeVertexPointer(edge.getStart().getIndex()),
+                       makeVertexPointer(edge.getEnd().getIndex()),
+                       edge.getWeight());
+        }
+    }
+
+    // Handles follow the elements into the new graph. The moved-from graph may
+    // only be assigned to or destroyed.
+    AdjacencyList(AdjacencyList&& other)
+        : m_ownedSymbols(std::move(other.m_ownedSymbols))
+        , m_symbols(std::move(other.m_symbols))
+        , m_vertexBySymbol(std::move(other.m_vertexBySymbol))
+        , m_vertices(std::move(other.m_vertices))
+        , m_edges(std::move(other.m_edges))
+        , m_vertexSlots(std::move(other.m_vertexSlots))
+        , m_edgeSlots(std::move(other.m_edgeSlots))
+    {
+
+    }
+
+    // The previous contents are destroyed with other, which releases the slot
+    // tables before the arenas.
+    AdjacencyList& operator=(AdjacencyList other)
+    {
+        swap(other);
+        return *this;
+    }
+
+    void swap(AdjacencyList& other)
+    {
+        std::swap(m_ownedSymbols, other.m_ownedSymbols);
+        std::swap(m_symbols, other.m_symbols);
+        std::swap(m_vertexBySymbol, other.m_vertexBySymbol);
+        std::swap(m_vertices, other.m_vertices);
+        std::swap(m_edges, other.m_edges);
+        std::swap(m_vertexSlots, other.m_vertexSlots);
+        std::swap(m_edgeSlots, other.m_edgeSlots);
+    }
 
     size_t getNumVertices() const
     {
@@ -33,68 +110,135 @@ public:
         return m_edges.size();
     }
 
+    const std::shared_ptr<const SymbolTable>& getSymbolTable() const
+    {
+        return m_symbols;
+    }
+
     AdjacencyList kruskal() const
     {
-        return ::kruskal<AdjacencyList>(m_edges, m_vertices.size());
+        return edgeSubgraph(kruskalEdgeIndices());
     }
 
-    vertex_pointer findVertex(const vertex_type& v) const
+    // Invokes sink with an edge_pointer to each minimum spanning forest edge of
+    // this graph and returns it, as std::for_each does.
+    template <typename EdgeSink>
+    EdgeSink kruskal(EdgeSink sink) const
     {
-        return findVertex(v.getId());
+        KruskalObserver observer;
+        return kruskal(std::move(sink), observer);
     }
 
-    vertex_pointer findVertex(vertex_id_type id) const
+    // As kruskal(sink), reporting each phase of the algorithm to observer; see KruskalObserver.
+    template <typename EdgeSink, typename Observer>
+    EdgeSink kruskal(EdgeSink sink, Observer& observer) const
     {
-        const auto vertexIt(std::find_if(begin(m_vertices), 
-                                         end(m_vertices), 
-                                         [&id](const std::shared_ptr<vertex_type>& v) { return v->getId() == id; } ));
-        
-        vertex_pointer result(std::shared_ptr<vertex_type>(nullptr), 0);
+        return kruskalEdges(getEdgePointers(), m_vertices.size(), std::move(sink), observer);
+    }
 
-        if (vertexIt != end(m_vertices))
-        {
-            result = vertex_pointer(*vertexIt, std::distance(begin(m_vertices), vertexIt));
-        }
+    std::vector<size_t> kruskalEdgeIndices() const
+    {
+        std::vector<size_t> result;
+        result.reserve(m_vertices.empty() ? 0 : m_vertices.size() - 1);
+
+        kruskalEdgeIndices(std::back_inserter(result));
 
         return result;
     }
 
-    edge_pointer findEdge(const vertex_pointer& startVertex, const vertex_pointer& endVertex, size_t weight) const
+    // Writes the index of each minimum spanning forest edge to out and returns
+    // the iterator past the last index written.
+    template <typename OutputIterator>
+    OutputIterator kruskalEdgeIndices(OutputIterator out) const
     {
-        return findEdge(startVertex->getId(), endVertex->getId(), weight);
+        kruskal([&out](const edge_pointer& edgePtr) { *out++ = edgePtr.getIndex(); });
+        return out;
     }
 
-    edge_pointer findEdge(vertex_id_type startId, vertex_id_type endId, size_t weight) const
+    // Single-linkage clustering: see ::kruskalForest. Labels are indexed by vertex index.
+    SpanningForest kruskalForest(size_t numClusters,
+                                 size_t maxWeight = std::numeric_limits<size_t>::max(),
+                                 bool buildDendrogram = false) const
     {
-        const auto edgeIt(std::find_if(begin(m_edges),
-                                       end(m_edges),
-                                       [&startId, &endId, weight](const std::shared_ptr<edge_type>& e)
-                                       { return weight  == e->getWeight()      &&
-                                                startId == e->getStart()->getId() &&
-                                                endId   == e->getEnd()->getId();
-                                       } ));
+        return ::kruskalForest(getEdgePointers(), m_vertices.size(), numClusters, maxWeight, buildDendrogram);
+    }
 
-        edge_pointer result(std::shared_ptr<edge_type>(nullptr), 0);
+    // Builds a graph holding only the given edges and their endpoints, sharing
+    // this graph's symbol table. Each index must appear at most once, which lets
+    // edges be appended without a dedupe scan; kruskal() uses this to build the tree.
+    AdjacencyList edgeSubgraph(const std::vector<size_t>& edgeIndices) const
+    {
+        AdjacencyList subgraph(m_symbols);
 
-        if (edgeIt != end(m_edges))
+        for (const auto edgeIdx : edgeIndices)
         {
-            result = edge_pointer(*edgeIt, std::distance(begin(m_edges), edgeIt));
+            if (edgeIdx >= m_edges.size())
+            {
+                std::ostringstream oss;
+                oss << "Edge index " << edgeIdx << " is out of range of edge buffer (size " << m_edges.size() << ").";
+                throw std::out_of_range(oss.str());
+            }
+
+            const auto& edge(m_edges[edgeIdx]);
+            subgraph.appendEdge(subgraph.addVertex(edge.getStart()->getSymbol()),
+                                subgraph.addVertex(edge.getEnd()->getSymbol()),
+                                edge.getWeight());
         }
 
-        return result;
+        return subgraph;
     }
 
-    vertex_pointer addVertex(vertex_type v)
+    std::vector<edge_pointer> getEdgePointers() const
     {
-        auto existingVertex(findVertex(v));
+        std::vector<edge_pointer> edges;
+        edges.reserve(m_edges.size());
+        for (size_t edgeIdx = 0; edgeIdx < m_edges.size(); ++edgeIdx)
+        {
+            edges.push_back(makeEdgePointer(edgeIdx));
+        }
 
-        if (!existingVertex.isValid())
+        return edges;
+    }
+
+    vertex_id_type getVertexId(const vertex_pointer& v) const
+    {
+        return m_symbols->getString((*v).getSymbol());
+    }
+
+    vertex_pointer findVertex(const vertex_type& v) const
+    {
+        return findVertex(v.getId());
+    }
+
+    vertex_pointer findVertex(const vertex_id_type& id) const
+    {
+        return findVertex(m_symbols->find(id));
+    }
+
+    edge_pointer findEdge(const vertex_pointer& startVertex, const vertex_pointer& endVertex, size_t weight) const
+    {
+        return findEdge((*startVertex).getSymbol(), (*endVertex).getSymbol(), weight);
+    }
+
+    edge_pointer findEdge(const vertex_id_type& startId, const vertex_id_type& endId, size_t weight) const
+    {
+        return findEdge(m_symbols->find(startId), m_symbols->find(endId), weight);
+    }
+
+    vertex_pointer addVertex(const vertex_id_type& id)
+    {
+        auto symbol(m_symbols->find(id));
+        if (symbol == SymbolTable::invalidSymbol())
         {
-            m_vertices.push_back(std::make_shared<vertex_type>(std::move(v)));
-            existingVertex = vertex_pointer(m_vertices.back(), m_vertices.size() - 1);
+            symbol = getMutableSymbols().intern(id);
         }
 
-        return existingVertex;
+        return addVertex(symbol);
+    }
+
+    vertex_pointer addVertex(const vertex_type& v)
+    {
+        return addVertex(v.getId());
     }
 
     edge_pointer addEdge(vertex_pointer start, vertex_pointer end, size_t weight)
@@ -103,13 +247,118 @@ public:
 
         if (!existingEdge.isValid())
         {
-            m_edges.push_back(std::make_shared<edge_type>(std::move(start), std::move(end), weight));
-            existingEdge = edge_pointer(m_edges.back(), m_edges.size() - 1);
+            existingEdge = appendEdge(std::move(start), std::move(end), weight);
         }
 
         return existingEdge;
     }
+
+    // Adds an edge without looking for an identical existing one. addEdge scans
+    // every edge, so loaders that already guarantee each edge is distinct, such
+    // as the synthetic generators, should use this to build a graph in linear time.
+    edge_pointer appendEdge(vertex_pointer start, vertex_pointer end, size_t weight)
+    {
+        const auto edgeIdx(insertSlot(m_edgeSlots, m_edges.create(edge_type(std::move(start), std::move(end), weight))));
+        return edge_pointer(*m_edgeSlots, edgeIdx);
+    }
 private:
-    vertex_container    m_vertices;
-    edge_container      m_edges;
+    static size_t invalidIndex()
+    {
+        return static_cast<size_t>(-1);
+    }
+
+    // The private copy keeps the shared table's numbering, so the symbols already
+    // stored in this graph's vertices remain valid without being reinterned.
+    SymbolTable& getMutableSymbols()
+    {
+        if (!m_ownedSymbols)
+        {
+            m_ownedSymbols = std::make_shared<SymbolTable>(*m_symbols);
+            m_symbols = m_ownedSymbols;
+        }
+
+        return *m_ownedSymbols;
+    }
+
+    vertex_pointer findVertex(SymbolTable::symbol_type symbol) const
+    {
+        if (symbol < m_vertexBySymbol.size() && m_vertexBySymbol[symbol] != invalidIndex())
+        {
+            return makeVertexPointer(m_vertexBySymbol[symbol]);
+        }
+
+        return vertex_pointer();
+    }
+
+    edge_pointer findEdge(SymbolTable::symbol_type startSymbol, SymbolTable::symbol_type endSymbol, size_t weight) const
+    {
+        if (startSymbol != SymbolTable::invalidSymbol() && endSymbol != SymbolTable::invalidSymbol())
+        {
+            for (size_t edgeIdx = 0; edgeIdx < m_edges.size(); ++edgeIdx)
+            {
+                const auto& e(m_edges[edgeIdx]);
+                if (weight      == e.getWeight()              &&
+                    startSymbol == e.getStart()->getSymbol()  &&
+                    endSymbol   == e.getEnd()->getSymbol())
+                {
+                    return makeEdgePointer(edgeIdx);
+                }
+            }
+        }
+
+        return edge_pointer();
+    }
+
+    vertex_pointer addVertex(SymbolTable::symbol_type symbol)
+    {
+        auto existingVertex(findVertex(symbol));
+
+        if (!existingVertex.isValid())
+        {
+            if (symbol >= m_vertexBySymbol.size())
+            {
+                m_vertexBySymbol.resize(symbol + 1, invalidIndex());
+            }
+
+            const auto vertexIdx(insertSlot(m_vertexSlots, m_vertices.create(interned_vertex_type(symbol))));
+            m_vertexBySymbol[symbol] = vertexIdx;
+            existingVertex = vertex_pointer(*m_vertexSlots, vertexIdx);
+        }
+
+        return existingVertex;
+    }
+
+    // Creating a slot table takes a slot in the process-wide handle registry, so
+    // tables are only created on the first insertion; graphs that stay empty
+    // never touch the registry.
+    template <typename T>
+    static typename SlotTable<T>::index_type insertSlot(typename SlotTable<T>::owner_type& slots, T* item)
+    {
+        if (!slots)
+        {
+            slots.reset(new SlotTable<T>);
+        }
+
+        return slots->insert(item);
+    }
+
+    vertex_pointer makeVertexPointer(size_t idx) const
+    {
+        return vertex_pointer(*m_vertexSlots, static_cast<vertex_pointer::index_type>(idx));
+    }
+
+    edge_pointer makeEdgePointer(size_t idx) const
+    {
+        return edge_pointer(*m_edgeSlots, static_cast<edge_pointer::index_type>(idx));
+    }
+
+    std::shared_ptr<SymbolTable>        m_ownedSymbols;
+    std::shared_ptr<const SymbolTable>  m_symbols;
+    std::vector<size_t>             m_vertexBySymbol;
+    vertex_container                m_vertices;
+    edge_container                  m_edges;
+
+    // Declared after the arenas so handles are invalidated before the items they refer to are destroyed.
+    SlotTable<interned_vertex_type>::owner_type  m_vertexSlots;
+    SlotTable<edge_type>::owner_type    m_edgeSlots;
 };
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <type_traits>
+#include <new>
+
+// Allocates items in fixed size blocks so that a graph with n elements performs
+// roughly n / BlockSize allocations instead of one per element. Items never move
+// once created, so pointers into the arena stay valid until it is cleared.
+template <typename T, size_t BlockSize = 256>
+class Arena
+{
+public:
+    Arena()
+        : m_size(0)
+    {
+
+    }
+
+    Arena(Arena&& other)
+        : m_blocks(std::move(other.m_blocks))
+        , m_size(other.m_size)
+    {
+        other.m_size = 0;
+    }
+
+    Arena& operator=(Arena&& other)
+    {
+        if (this != &other)
+        {
+            clear();
+            m_blocks = std::move(other.m_blocks);
+            m_size = other.m_size;
+            other.m_size = 0;
+        }
+
+        return *this;
+    }
+
+    ~Arena()
+    {
+        clear();
+    }
+
+    T* create(T item)
+    {
+        if (m_size == m_blocks.size() * BlockSize)
+        {
+            m_blocks.push_back(std::unique_ptr<Block>(new Block));
+        }
+
+        T* result = slot(m_size);
+        new (result) T(std::move(item));
+        ++m_size;
+
+        return result;
+    }
+
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    T& operator[](size_t idx)
+    {
+        return *slot(idx);
+    }
+
+    const T& operator[](size_t idx) const
+    {
+        return *slot(idx);
+    }
+
+    void clear()
+    {
+        while (m_size > 0)
+        {
+            --m_size;
+            slot(m_size)->~T();
+        }
+    }
+private:
+    Arena(const Arena&);
+    Arena& operator=(const Arena&);
+
+    typedef typename std::aligned_storage<sizeof(T), std::alignment_of<T>::value>::type Slot;
+
+    struct Block
+    {
+        Slot slots[BlockSize];
+    };
+
+    T* slot(size_t idx) const
+    {
+        return reinterpret_cast<T*>(&m_blocks[idx / BlockSize]->slots[idx % BlockSize]);
+    }
+
+    std::vector<std::unique_ptr<Block>> m_blocks;
+    size_t m_size;
+};
@@ -0,0 +1,363 @@
+// Times each phase of building a graph and computing its minimum spanning tree
+// on synthetic inputs. Prints one JSON object per graph so results can be
+// collected and compared between builds.
+//
+// Usage: KruskalBenchmark [seed] [scale]
+//   seed   generator seed (default 1)
+//   scale  multiplies the default problem sizes (default 1)
+
+#include <boost/timer/timer.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "AdjacencyList.h"
+#include "GraphGenerators.h"
+
+namespace
+{
+    // Bytes currently allocated through operator new and the high-water mark
+    // since the last reset. The benchmark is single threaded.
+    size_t g_heapInUse = 0;
+    size_t g_heapPeak = 0;
+
+    // Size prefix stored in front of each block; large enough to keep the
+    // returned pointer aligned for any fundamental type.
+    const size_t allocationHeader = 16;
+
+    void* trackedAllocate(size_t size)
+    {
+        auto* block(static_cast<char*>(std::malloc(size + allocationHeader)));
+        if (!block)
+        {
+            return nullptr;
+        }
+
+        *reinterpret_cast<size_t*>(block) = size;
+        g_heapInUse += size;
+        g_heapPeak = std::max(g_heapPeak, g_heapInUse);
+
+        return block + allocationHeader;
+    }
+
+    void trackedFree(void* ptr)
+    {
+        if (ptr)
+        {
+            auto* block(static_cast<char*>(ptr) - allocationHeader);
+            g_heapInUse -= *reinterpret_cast<size_t*>(block);
+            std::free(block);
+        }
+    }
+}
+
+void* operator new(size_t size)
+{
+    auto* ptr(trackedAllocate(size));
+    if (!ptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    return ptr;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) throw()
+{
+    return trackedAllocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) throw()
+{
+    return trackedAllocate(size);
+}
+
+void operator delete(void* ptr) throw()
+{
+    trackedFree(ptr);
+}
+
+void operator delete[](void* ptr) throw()
+{
+    trackedFree(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) throw()
+{
+    trackedFree(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) throw()
+{
+    trackedFree(ptr);
+}
+
+namespace
+{
+    // Each timed phase runs once to warm up and then this many times; the
+    // median is reported.
+    const size_t numRepeats = 5;
+
+    double elapsedMs(const boost::timer::cpu_timer& timer)
+    {
+        return timer.elapsed().wall / 1.0e6;
+    }
+
+    double median(std::vector<double> samples)
+    {
+        std::sort(begin(samples), end(samples));
+        return samples[samples.size() / 2];
+    }
+
+    template <typename Func>
+    double timeMedianMs(Func func)
+    {
+        func();
+
+        std::vector<double> samples;
+        for (size_t repeat = 0; repeat < numRepeats; ++repeat)
+        {
+            boost::timer::cpu_timer timer;
+            func();
+            samples.push_back(elapsedMs(timer));
+        }
+
+        return median(samples);
+    }
+
+    // Times the sort and union-find scan inside the library's kruskalEdges.
+    class PhaseTimer : public KruskalObserver
+    {
+    public:
+        PhaseTimer()
+            : m_sortMs(0.0)
+            , m_scanMs(0.0)
+        {
+
+        }
+
+        void beginSort()
+        {
+            m_timer.start();
+        }
+
+        void beginScan()
+        {
+            m_sortMs = elapsedMs(m_timer);
+            m_timer.start();
+        }
+
+        void endScan()
+        {
+            m_scanMs = elapsedMs(m_timer);
+        }
+
+        double getSortMs() const
+        {
+            return m_sortMs;
+        }
+
+        double getScanMs() const
+        {
+            return m_scanMs;
+        }
+    private:
+        boost::timer::cpu_timer m_timer;
+        double                  m_sortMs;
+        double                  m_scanMs;
+    };
+
+    // Records how many parent links each find in the scan has to follow.
+    class PathLengthObserver : public KruskalObserver
+    {
+    public:
+        PathLengthObserver()
+            : m_numFinds(0)
+            , m_totalLength(0)
+            , m_maxLength(0)
+        {
+
+        }
+
+        void examineEdge(size_t startIndex, size_t endIndex, const UnionFind& components)
+        {
+            record(components.getPathLength(startIndex));
+            record(components.getPathLength(endIndex));
+        }
+
+        double getMeanLength() const
+        {
+            return m_numFinds == 0 ? 0.0 : static_cast<double>(m_totalLength) / m_numFinds;
+        }
+
+        size_t getMaxLength() const
+        {
+            return m_maxLength;
+        }
+    private:
+        void record(size_t length)
+        {
+            ++m_numFinds;
+            m_totalLength += length;
+            m_maxLength = std::max(m_maxLength, length);
+        }
+
+        size_t m_numFinds;
+        size_t m_totalLength;
+        size_t m_maxLength;
+    };
+
+    struct BenchmarkResult
+    {
+        double constructionMs;
+        double sortMs;
+        double scanMs;
+        double mstEdgesMs;
+        double materializationMs;
+        double mstGraphMs;
+
+        size_t mstEdges;
+        size_t mstWeight;
+        double meanPathLength;
+        size_t maxPathLength;
+
+        size_t graphHeapKb;
+        size_t peakHeapKb;
+    };
+
+    // The generators never produce duplicate edges, so edges are appended
+    // without addEdge's linear search for an existing one.
+    AdjacencyList buildGraph(const GeneratedGraph& input)
+    {
+        AdjacencyList graph;
+
+        std::vector<AdjacencyList::vertex_pointer> vertices;
+        vertices.reserve(input.numVertices);
+        for (size_t vertexIdx = 0; vertexIdx < input.numVertices; ++vertexIdx)
+        {
+            vertices.push_back(graph.addVertex(std::to_string(vertexIdx)));
+        }
+
+        for (const auto& edge : input.edges)
+        {
+            graph.appendEdge(vertices[edge.start], vertices[edge.end], edge.weight);
+        }
+
+        return graph;
+    }
+
+    BenchmarkResult runBenchmark(const GeneratedGraph& input)
+    {
+        typedef AdjacencyList::edge_pointer edge_pointer;
+
+        BenchmarkResult result = {};
+
+        const auto heapBaseline(g_heapInUse);
+        g_heapPeak = g_heapInUse;
+
+        result.constructionMs = timeMedianMs([&input]() { buildGraph(input); });
+
+        const auto graph(buildGraph(input));
+        result.graphHeapKb = (g_heapInUse - heapBaseline) / 1024;
+
+        {
+            const auto noSink = [](const edge_pointer&) {};
+
+            PhaseTimer warmUp;
+            graph.kruskal(noSink, warmUp);
+
+            std::vector<double> sortSamples;
+            std::vector<double> scanSamples;
+            for (size_t repeat = 0; repeat < numRepeats; ++repeat)
+            {
+                PhaseTimer phases;
+                graph.kruskal(noSink, phases);
+                sortSamples.push_back(phases.getSortMs());
+                scanSamples.push_back(phases.getScanMs());
+            }
+
+            result.sortMs = median(sortSamples);
+            result.scanMs = median(scanSamples);
+
+            PathLengthObserver pathLengths;
+            graph.kruskal([&result](const edge_pointer& edgePtr) { result.mstWeight += edgePtr->getWeight(); }, pathLengths);
+            result.meanPathLength = pathLengths.getMeanLength();
+            result.maxPathLength = pathLengths.getMaxLength();
+        }
+
+        std::vector<size_t> edgeIndices;
+        result.mstEdgesMs = timeMedianMs([&]() { edgeIndices = graph.kruskalEdgeIndices(); });
+        result.mstEdges = edgeIndices.size();
+
+        result.materializationMs = timeMedianMs([&]() { graph.edgeSubgraph(edgeIndices); });
+        result.mstGraphMs = timeMedianMs([&]() { graph.kruskal(); });
+
+        result.peakHeapKb = (g_heapPeak - heapBaseline) / 1024;
+
+        return result;
+    }
+
+    void report(const std::string& generator, std::uint32_t seed, const GeneratedGraph& input, const BenchmarkResult& result)
+    {
+        std::cout << "{\"generator\": \"" << generator << "\""
+                  << ", \"seed\": " << seed
+                  << ", \"vertices\": " << input.numVertices
+                  << ", \"edges\": " << input.edges.size()
+                  << ", \"construction_ms\": " << result.constructionMs
+                  << ", \"sort_ms\": " << result.sortMs
+                  << ", \"union_find_scan_ms\": " << result.scanMs
+                  << ", \"mst_edge_indices_ms\": " << result.mstEdgesMs
+                  << ", \"mst_materialization_ms\": " << result.materializationMs
+                  << ", \"mst_graph_ms\": " << result.mstGraphMs
+                  << ", \"mst_edges\": " << result.mstEdges
+                  << ", \"mst_weight\": " << result.mstWeight
+                  << ", \"union_find_mean_path_length\": " << result.meanPathLength
+                  << ", \"union_find_max_path_length\": " << result.maxPathLength
+                  << ", \"graph_heap_kb\": " << result.graphHeapKb
+                  << ", \"peak_heap_kb\": " << result.peakHeapKb
+                  << "}" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const auto seed(argc > 1 ? static_cast<std::uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 1u);
+    const auto scale(argc > 2 ? std::max<size_t>(1, std::strtoul(argv[2], nullptr, 10)) : 1u);
+
+    {
+        const auto input(generateGrid(500 * scale, 500, seed));
+        report("grid", seed, input, runBenchmark(input));
+    }
+
+    {
+        const auto input(generateErdosRenyi(100000 * scale, 500000 * scale, seed));
+        report("erdos_renyi", seed, input, runBenchmark(input));
+    }
+
+    {
+        size_t rmatScale = 17;
+        for (size_t remaining = scale; remaining > 1; remaining /= 2)
+        {
+            ++rmatScale;
+        }
+
+        const auto input(generateRmat(rmatScale, 500000 * scale, seed));
+        report("rmat", seed, input, runBenchmark(input));
+    }
+
+    {
+        const auto input(generateComplete(1000 * scale, seed));
+        report("complete", seed, input, runBenchmark(input));
+    }
+
+    return 0;
+}
@@ -0,0 +1,246 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+template <typename T>
+class GenerationalHandle;
+
+// Maps handle indices to the items of a single owner, which holds the table
+// directly and frees it along with its items.
+//
+// Dangling handles are detected through a process-wide registry of owner slots.
+// Each table holds a registry slot for its lifetime, and destroying the table
+// bumps that slot's generation. A handle records the slot and generation it was
+// created under and is only valid while they still match. Registry entries are
+// allocated in blocks that are never moved or freed, so a handle that outlives
+// its table still reads live memory. The memory retained per element type is one
+// RegistryEntry per table alive at once, at the peak.
+template <typename T>
+class SlotTable
+{
+public:
+    typedef std::uint32_t index_type;
+    typedef std::uint32_t generation_type;
+
+    typedef std::unique_ptr<SlotTable> owner_type;
+
+    SlotTable()
+        : m_slot(acquireSlot())
+        , m_generation(getEntry(m_slot).generation.load(std::memory_order_relaxed))
+    {
+        getEntry(m_slot).table = this;
+    }
+
+    ~SlotTable()
+    {
+        releaseSlot(m_slot, m_generation);
+    }
+
+    index_type insert(T* item)
+    {
+        if (m_items.size() == std::numeric_limits<index_type>::max())
+        {
+            throw std::length_error("Slot table index space exhausted.");
+        }
+
+        const auto index(static_cast<index_type>(m_items.size()));
+        m_items.push_back(item);
+
+        return index;
+    }
+
+    size_t size() const
+    {
+        return m_items.size();
+    }
+private:
+    friend class GenerationalHandle<T>;
+
+    enum
+    {
+        entriesPerBlock = 1024,
+        maxBlocks = 4096
+    };
+
+    struct RegistryEntry
+    {
+        RegistryEntry()
+            : generation(0)
+            , table(nullptr)
+            , nextFree(0)
+        {
+
+        }
+
+        // Written only when the owning table is destroyed, and read by handles
+        // on any thread.
+        std::atomic<generation_type>    generation;
+        const SlotTable*                table;
+
+        // One more than the next free slot, or zero at the end of the free list.
+        index_type                      nextFree;
+    };
+
+    // Guards the registry's free list and block allocation. It is only taken
+    // when a table is created or destroyed, and is a constant-initialised
+    // spinlock, so it is safe to use before and during static initialisation.
+    class RegistryLock
+    {
+    public:
+        RegistryLock()
+        {
+            while (s_registryLock.test_and_set(std::memory_order_acquire))
+            {
+            }
+        }
+
+        ~RegistryLock()
+        {
+            s_registryLock.clear(std::memory_order_release);
+        }
+    private:
+        RegistryLock(const RegistryLock&);
+        RegistryLock& operator=(const RegistryLock&);
+    };
+
+    SlotTable(const SlotTable&);
+    SlotTable& operator=(const SlotTable&);
+
+    static index_type invalidSlot()
+    {
+        return std::numeric_limits<index_type>::max();
+    }
+
+    static RegistryEntry& getEntry(index_type slot)
+    {
+        return s_blocks[slot / entriesPerBlock][slot % entriesPerBlock];
+    }
+
+    static index_type acquireSlot()
+    {
+        RegistryLock lock;
+
+        if (s_freeListHead != 0)
+        {
+            const auto slot(s_freeListHead - 1);
+            s_freeListHead = getEntry(slot).nextFree;
+            return slot;
+        }
+
+        if (s_numSlots == static_cast<index_type>(entriesPerBlock) * maxBlocks)
+        {
+            throw std::length_error("Too many slot tables alive at once.");
+        }
+
+        if (s_numSlots % entriesPerBlock == 0)
+        {
+            s_blocks[s_numSlots / entriesPerBlock] = new RegistryEntry[entriesPerBlock];
+        }
+
+        return s_numSlots++;
+    }
+
+    static void releaseSlot(index_type slot, generation_type generation)
+    {
+        auto& entry(getEntry(slot));
+        entry.generation.store(generation + 1, std::memory_order_release);
+
+        RegistryLock lock;
+        entry.nextFree = s_freeListHead;
+        s_freeListHead = slot + 1;
+    }
+
+    static RegistryEntry*   s_blocks[maxBlocks];
+    static index_type       s_numSlots;
+    static index_type       s_freeListHead;
+    static std::atomic_flag s_registryLock;
+
+    std::vector<T*>         m_items;
+    const index_type        m_slot;
+    const generation_type   m_generation;
+};
+
+template <typename T>
+typename SlotTable<T>::RegistryEntry* SlotTable<T>::s_blocks[SlotTable<T>::maxBlocks];
+
+template <typename T>
+typename SlotTable<T>::index_type SlotTable<T>::s_numSlots = 0;
+
+template <typename T>
+typename SlotTable<T>::index_type SlotTable<T>::s_freeListHead = 0;
+
+template <typename T>
+std::atomic_flag SlotTable<T>::s_registryLock = ATOMIC_FLAG_INIT;
+
+// A trivially copyable reference to an item owned through a SlotTable. Checking
+// a handle is a single atomic load of its registry generation, so handles can be
+// copied freely between threads without touching any reference counts.
+template <typename T>
+class GenerationalHandle
+{
+public:
+    typedef typename SlotTable<T>::index_type index_type;
+    typedef typename SlotTable<T>::generation_type generation_type;
+
+    GenerationalHandle()
+        : m_slot(SlotTable<T>::invalidSlot())
+        , m_index(0)
+        , m_generation(0)
+    {
+
+    }
+
+    GenerationalHandle(const SlotTable<T>& table, index_type index)
+        : m_slot(table.m_slot)
+        , m_index(index)
+        , m_generation(table.m_generation)
+    {
+
+    }
+
+    bool isValid() const
+    {
+        return m_slot != SlotTable<T>::invalidSlot() &&
+               SlotTable<T>::getEntry(m_slot).generation.load(std::memory_order_acquire) == m_generation;
+    }
+
+    size_t getIndex() const
+    {
+        if (isValid())
+        {
+            return m_index;
+        }
+
+        throw std::logic_error("Attempt to get index from invalid handle.");
+    }
+
+    T* get() const
+    {
+        return isValid() ? SlotTable<T>::getEntry(m_slot).table->m_items[m_index] : nullptr;
+    }
+
+    T& operator*() const
+    {
+        auto* ptr(get());
+        if (ptr)
+        {
+            return *ptr;
+        }
+
+        throw std::logic_error("Attempt to dereference invalid handle.");
+    }
+
+    T* operator->() const
+    {
+        return get();
+    }
+private:
+    index_type      m_slot;
+    index_type      m_index;
+    generation_type m_generation;
+};
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <vector>
+#include <random>
+#include <unordered_set>
+#include <algorithm>
+#include <cstdint>
+
+// Synthetic weighted graphs for tests and benchmarks. Every generator is
+// deterministic for a given seed and standard library, and produces undirected
+// simple graphs: no self loops and at most one edge between any pair of vertices.
+struct GeneratedEdge
+{
+    size_t start;
+    size_t end;
+    size_t weight;
+};
+
+struct GeneratedGraph
+{
+    size_t                      numVertices;
+    std::vector<GeneratedEdge>  edges;
+};
+
+namespace detail
+{
+    class EdgeBuilder
+    {
+    public:
+        EdgeBuilder(size_t numVertices, std::uint32_t seed, size_t maxWeight)
+            : m_rng(seed)
+            , m_weights(1, maxWeight)
+        {
+            m_graph.numVertices = numVertices;
+        }
+
+        std::mt19937& getRng()
+        {
+            return m_rng;
+        }
+
+        size_t getNumEdges() const
+        {
+            return m_graph.edges.size();
+        }
+
+        bool add(size_t start, size_t end)
+        {
+            if (start == end || !m_seen.insert(key(start, end)).second)
+            {
+                return false;
+            }
+
+            const GeneratedEdge edge = { start, end, m_weights(m_rng) };
+            m_graph.edges.push_back(edge);
+            return true;
+        }
+
+        GeneratedGraph release()
+        {
+            return std::move(m_graph);
+        }
+    private:
+        static std::uint64_t key(size_t start, size_t end)
+        {
+            return (static_cast<std::uint64_t>(std::min(start, end)) << 32) | std::max(start, end);
+        }
+
+        std::mt19937                                m_rng;
+        std::uniform_int_distribution<size_t>       m_weights;
+        std::unordered_set<std::uint64_t>           m_seen;
+        GeneratedGraph                              m_graph;
+    };
+}
+
+// Erdos-Renyi G(n, m): numEdges distinct edges chosen uniformly at random.
+// numEdges is capped at the number of possible edges.
+inline GeneratedGraph generateErdosRenyi(size_t numVertices, size_t numEdges, std::uint32_t seed, size_t maxWeight = 1000)
+{
+    detail::EdgeBuilder builder(numVertices, seed, maxWeight);
+
+    const auto maxEdges(numVertices < 2 ? 0 : numVertices * (numVertices - 1) / 2);
+    numEdges = std::min(numEdges, maxEdges);
+
+    if (numEdges > 0)
+    {
+        std::uniform_int_distribution<size_t> vertices(0, numVertices - 1);
+        while (builder.getNumEdges() < numEdges)
+        {
+            const auto start(vertices(builder.getRng()));
+            builder.add(start, vertices(builder.getRng()));
+        }
+    }
+
+    return builder.release();
+}
+
+// width x height lattice with edges between horizontal and vertical neighbours.
+inline GeneratedGraph generateGrid(size_t width, size_t height, std::uint32_t seed, size_t maxWeight = 1000)
+{
+    detail::EdgeBuilder builder(width * height, seed, maxWeight);
+
+    for (size_t row = 0; row < height; ++row)
+    {
+        for (size_t col = 0; col < width; ++col)
+        {
+            const auto vertex(row * width + col);
+
+            if (col + 1 < width)
+            {
+                builder.add(vertex, vertex + 1);
+            }
+
+            if (row + 1 < height)
+            {
+                builder.add(vertex, vertex + width);
+            }
+        }
+    }
+
+    return builder.release();
+}
+
+// R-MAT power-law graph on 2^scale vertices. Each edge recursively picks one of
+// the four adjacency matrix quadrants with probabilities a, b, c and 1 - a - b - c.
+// Duplicate edges and self loops are redrawn, giving up after 8 * numEdges draws.
+inline GeneratedGraph generateRmat(size_t scale, size_t numEdges, std::uint32_t seed,
+                                   double a = 0.57, double b = 0.19, double c = 0.19,
+                                   size_t maxWeight = 1000)
+{
+    const size_t numVertices = static_cast<size_t>(1) << scale;
+    detail::EdgeBuilder builder(numVertices, seed, maxWeight);
+
+    std::uniform_real_distribution<double> quadrant(0.0, 1.0);
+
+    for (size_t attempt = 0; attempt < numEdges * 8 && builder.getNumEdges() < numEdges; ++attempt)
+    {
+        size_t start = 0;
+        size_t end = 0;
+
+        for (size_t bit = 0; bit < scale; ++bit)
+        {
+            const auto p(quadrant(builder.getRng()));
+
+            start <<= 1;
+            end <<= 1;
+
+            if (p >= a + b + c)
+            {
+                start |= 1;
+                end |= 1;
+            }
+            else if (p >= a + b)
+            {
+                start |= 1;
+            }
+            else if (p >= a)
+            {
+                end |= 1;
+            }
+        }
+
+        builder.add(start, end);
+    }
+
+    return builder.release();
+}
+
+inline GeneratedGraph generateComplete(size_t numVertices, std::uint32_t seed, size_t maxWeight = 1000)
+{
+    detail::EdgeBuilder builder(numVertices, seed, maxWeight);
+
+    for (size_t start = 0; start < numVertices; ++start)
+    {
+        for (size_t end = start + 1; end < numVertices; ++end)
+        {
+            builder.add(start, end);
+        }
+    }
+
+    return builder.release();
+}
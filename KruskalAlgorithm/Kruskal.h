@@ -1,12 +1,107 @@
 #pragma once
 
+#include <vector>
+#include <algorithm>
+#include <limits>
+
 #include "Kruskal.h"
 #include "AdjacencyList.h"
 #include "UnionFind.h"
 
-template <typename GraphType, typename EdgeSequence>
-GraphType kruskal(EdgeSequence edges, size_t numVertices)
+// One step of single-linkage clustering. Clusters 0 to numVertices - 1 are the
+// individual vertices and merge i creates cluster numVertices + i.
+struct DendrogramMerge
+{
+    size_t left;
+    size_t right;
+    size_t weight;
+    size_t size;
+};
+
+struct SpanningForest
 {
+    // Component of each vertex index, numbered densely from zero.
+    std::vector<size_t>             labels;
+    size_t                          numComponents;
+
+    // Merges in order of increasing weight; empty unless requested.
+    std::vector<DendrogramMerge>    dendrogram;
+};
+
+namespace detail
+{
+    // Consumes edges lightest first until stop returns true for the next edge,
+    // calling sink with the edge and both component roots before each merge.
+    // Edges are kept in a binary heap rather than sorted, so stopping early
+    // never pays to order the remainder of the list. Popping every edge costs
+    // several times more than std::sort, so this is only used where early
+    // termination is expected.
+    template <typename EdgeSequence, typename StopPredicate, typename MergeSink>
+    void kruskalScan(EdgeSequence& edges, UnionFind& components, StopPredicate stop, MergeSink sink)
+    {
+        typedef typename EdgeSequence::value_type edge_pointer;
+
+        const auto heavier = [](const edge_pointer& lhs, const edge_pointer& rhs)
+        {
+            return *rhs < *lhs;
+        };
+
+        std::make_heap(begin(edges), end(edges), heavier);
+
+        for (auto heapEnd = end(edges); heapEnd != begin(edges) && !stop(edges.front()); --heapEnd)
+        {
+            std::pop_heap(begin(edges), heapEnd, heavier);
+            const auto& edgePtr = *std::prev(heapEnd);
+
+            const auto startRoot = components.findRoot(edgePtr->getStart().getIndex());
+            const auto endRoot = components.findRoot(edgePtr->getEnd().getIndex());
+
+            if (startRoot != endRoot)
+            {
+                sink(edgePtr, startRoot, endRoot);
+                components.merge(startRoot, endRoot);
+            }
+        }
+    }
+}
+
+// Hooks into the phases of kruskalEdges. Every hook does nothing; callers such
+// as the benchmark hide the ones they need in a derived type to time or
+// inspect the real scan. Hooks are resolved statically, so the default costs
+// nothing.
+struct KruskalObserver
+{
+    void beginSort()
+    {
+
+    }
+
+    void beginScan()
+    {
+
+    }
+
+    // Called for every edge examined, before its endpoints are looked up.
+    void examineEdge(size_t, size_t, const UnionFind&)
+    {
+
+    }
+
+    void endScan()
+    {
+
+    }
+};
+
+// Invokes sink with each edge of the minimum spanning forest, in order of
+// increasing weight. Nothing is built on behalf of the caller, so callers that
+// only need edge ids or the total weight do not pay for a result graph.
+// Returns the sink, as std::for_each does, so stateful sinks can be inspected.
+template <typename EdgeSequence, typename EdgeSink, typename Observer>
+EdgeSink kruskalEdges(EdgeSequence edges, size_t numVertices, EdgeSink sink, Observer& observer)
+{
+    observer.beginSort();
+
     std::sort(
         begin(edges), 
         end(edges),
@@ -16,28 +111,108 @@ GraphType kruskal(EdgeSequence edges, size_t numVertices)
             return *lhs < *rhs;
         });
 
+    observer.beginScan();
+
     UnionFind components(numVertices);
-    GraphType minimumSpanningTree;
 
-    for (const auto edgePtr : edges)
+    for (const auto& edgePtr : edges)
     {
-        const auto* edge = edgePtr.get();
+        // A spanning tree has numVertices - 1 edges; the rest of the list can only form cycles.
+        if (components.getNumComponents() <= 1)
+        {
+            break;
+        }
+
+        const auto startIndex = edgePtr->getStart().getIndex();
+        const auto endIndex = edgePtr->getEnd().getIndex();
 
-        const auto startVertex(edge->getStart());
-        const auto endVertex(edge->getEnd());
+        observer.examineEdge(startIndex, endIndex, components);
 
-        const auto startIndex = startVertex.getIndex();
-        const auto endIndex = endVertex.getIndex();
+        const auto startRoot = components.findRoot(startIndex);
+        const auto endRoot = components.findRoot(endIndex);
 
-        if (!components.sameComponent(startIndex, endIndex))
+        if (startRoot != endRoot)
         {
-            const auto mstStartVertex(minimumSpanningTree.addVertex(*startVertex));
-            const auto mstEndVertex(minimumSpanningTree.addVertex(*endVertex));
-            minimumSpanningTree.addEdge(mstStartVertex, mstEndVertex, edge->getWeight());
+            sink(edgePtr);
+            components.merge(startRoot, endRoot);
+        }
+    }
+
+    observer.endScan();
+
+    return sink;
+}
+
+template <typename EdgeSequence, typename EdgeSink>
+EdgeSink kruskalEdges(EdgeSequence edges, size_t numVertices, EdgeSink sink)
+{
+    KruskalObserver observer;
+    return kruskalEdges(std::move(edges), numVertices, std::move(sink), observer);
+}
 
-            components.merge(startIndex, endIndex);
+// Runs Kruskal's algorithm only until the forest has numClusters components or
+// the next edge is heavier than maxWeight, whichever comes first. This is
+// single-linkage clustering without computing and then cutting the full tree.
+// A forest always has at least one component, so numClusters below 1 is treated as 1.
+template <typename EdgeSequence>
+SpanningForest kruskalForest(EdgeSequence edges,
+                             size_t numVertices,
+                             size_t numClusters,
+                             size_t maxWeight = std::numeric_limits<size_t>::max(),
+                             bool buildDendrogram = false)
+{
+    typedef typename EdgeSequence::value_type edge_pointer;
+
+    numClusters = std::max<size_t>(numClusters, 1);
+
+    UnionFind components(numVertices);
+    SpanningForest result;
+
+    // Cluster id and size of each component, indexed by its current root.
+    std::vector<size_t> rootClusters;
+    std::vector<size_t> rootSizes;
+
+    if (buildDendrogram)
+    {
+        rootClusters.reserve(numVertices);
+        for (size_t vertexIdx = 0; vertexIdx < numVertices; ++vertexIdx)
+        {
+            rootClusters.push_back(vertexIdx);
         }
+
+        rootSizes.assign(numVertices, 1);
+        result.dendrogram.reserve(numVertices > numClusters ? numVertices - numClusters : 0);
     }
 
-    return minimumSpanningTree;
+    detail::kruskalScan(
+        edges,
+        components,
+        [&components, numClusters, maxWeight](const edge_pointer& edgePtr)
+        {
+            return components.getNumComponents() <= numClusters || edgePtr->getWeight() > maxWeight;
+        },
+        [&](const edge_pointer& edgePtr, size_t startRoot, size_t endRoot)
+        {
+            if (buildDendrogram)
+            {
+                const DendrogramMerge step =
+                {
+                    rootClusters[startRoot],
+                    rootClusters[endRoot],
+                    edgePtr->getWeight(),
+                    rootSizes[startRoot] + rootSizes[endRoot]
+                };
+
+                result.dendrogram.push_back(step);
+
+                // Both roots are updated because the surviving root is only known after the merge.
+                rootClusters[startRoot] = rootClusters[endRoot] = numVertices + result.dendrogram.size() - 1;
+                rootSizes[startRoot] = rootSizes[endRoot] = step.size;
+            }
+        });
+
+    result.labels = components.getComponentLabels();
+    result.numComponents = components.getNumComponents();
+
+    return result;
 }
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <sstream>
+
+// Interns strings into a single contiguous character pool. Each distinct string
+// is assigned a dense integer symbol, so callers can compare ids with a single
+// integer comparison instead of a string comparison.
+class SymbolTable
+{
+public:
+    typedef std::uint32_t symbol_type;
+
+    static symbol_type invalidSymbol()
+    {
+        return std::numeric_limits<symbol_type>::max();
+    }
+
+    SymbolTable()
+        : m_offsets(1, 0)
+        , m_buckets(16, invalidSymbol())
+    {
+
+    }
+
+    size_t size() const
+    {
+        return m_hashes.size();
+    }
+
+    symbol_type intern(const std::string& str)
+    {
+        const auto hash(hashString(str.data(), str.size()));
+        auto bucket(findBucket(str.data(), str.size(), hash));
+
+        if (m_buckets[bucket] != invalidSymbol())
+        {
+            return m_buckets[bucket];
+        }
+
+        // Keep the load factor at or below 3/4 so probe sequences stay short.
+        if ((size() + 1) * 4 > m_buckets.size() * 3)
+        {
+            rehash(m_buckets.size() * 2);
+            bucket = findBucket(str.data(), str.size(), hash);
+        }
+
+        const auto symbol(static_cast<symbol_type>(size()));
+        m_pool.insert(end(m_pool), begin(str), end(str));
+        m_offsets.push_back(m_pool.size());
+        m_hashes.push_back(hash);
+        m_buckets[bucket] = symbol;
+
+        return symbol;
+    }
+
+    symbol_type find(const std::string& str) const
+    {
+        return m_buckets[findBucket(str.data(), str.size(), hashString(str.data(), str.size()))];
+    }
+
+    std::string getString(symbol_type symbol) const
+    {
+        if (symbol < size())
+        {
+            return std::string(m_pool.data() + m_offsets[symbol], m_pool.data() + m_offsets[symbol + 1]);
+        }
+
+        std::ostringstream oss;
+        oss << "Symbol " << symbol << " is out of range of symbol table (size " << size() << ").";
+        throw std::out_of_range(oss.str());
+    }
+private:
+    size_t findBucket(const char* str, size_t length, std::uint32_t hash) const
+    {
+        const auto mask(m_buckets.size() - 1);
+        auto bucket(hash & mask);
+
+        while (m_buckets[bucket] != invalidSymbol() && !matches(m_buckets[bucket], str, length, hash))
+        {
+            bucket = (bucket + 1) & mask;
+        }
+
+        return bucket;
+    }
+
+    bool matches(symbol_type symbol, const char* str, size_t length, std::uint32_t hash) const
+    {
+        const auto offset(m_offsets[symbol]);
+
+        return m_hashes[symbol] == hash &&
+               m_offsets[symbol + 1] - offset == length &&
+               (length == 0 || std::memcmp(m_pool.data() + offset, str, length) == 0);
+    }
+
+    void rehash(size_t numBuckets)
+    {
+        m_buckets.assign(numBuckets, invalidSymbol());
+
+        const auto mask(numBuckets - 1);
+        for (size_t symbol = 0; symbol < size(); ++symbol)
+        {
+            auto bucket(m_hashes[symbol] & mask);
+            while (m_buckets[bucket] != invalidSymbol())
+            {
+                bucket = (bucket + 1) & mask;
+            }
+
+            m_buckets[bucket] = static_cast<symbol_type>(symbol);
+        }
+    }
+
+    // 32-bit FNV-1a
+    static std::uint32_t hashString(const char* str, size_t length)
+    {
+        std::uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < length; ++i)
+        {
+            hash ^= static_cast<unsigned char>(str[i]);
+            hash *= 16777619u;
+        }
+
+        return hash;
+    }
+
+    std::vector<char>           m_pool;
+    std::vector<size_t>         m_offsets;
+    std::vector<std::uint32_t>  m_hashes;
+    std::vector<symbol_type>    m_buckets;
+};
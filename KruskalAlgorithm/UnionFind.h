@@ -10,6 +10,7 @@ class UnionFind
 {
 public:
     explicit UnionFind(size_t numVerts)
+        : m_numComponents(numVerts)
     {
         m_components.reserve(numVerts);
         size_t parentIdx = 0;
@@ -18,6 +19,36 @@ public:
                         [&]() { return UnionFindNode(parentIdx++); });
     }
 
+    size_t getNumComponents() const
+    {
+        return m_numComponents;
+    }
+
+    // Labels every element with its component, numbered densely from zero in
+    // order of each component's first element.
+    std::vector<size_t> getComponentLabels() const
+    {
+        const auto unlabelled(m_components.size());
+
+        std::vector<size_t> rootLabels(m_components.size(), unlabelled);
+        std::vector<size_t> labels;
+        labels.reserve(m_components.size());
+
+        size_t nextLabel = 0;
+        for (size_t elem = 0; elem < m_components.size(); ++elem)
+        {
+            auto& rootLabel(rootLabels[findRoot(elem)]);
+            if (rootLabel == unlabelled)
+            {
+                rootLabel = nextLabel++;
+            }
+
+            labels.push_back(rootLabel);
+        }
+
+        return labels;
+    }
+
     bool sameComponent(size_t start, size_t end) const
     {
         return findRoot(start) == findRoot(end);
@@ -44,6 +75,20 @@ public:
         throw std::out_of_range(oss.str());
     }
 
+    // Number of parent links findRoot follows from elem to its root.
+    size_t getPathLength(size_t elem) const
+    {
+        const auto root(findRoot(elem));
+
+        size_t length = 0;
+        for (; elem != root; elem = m_components[elem].parentIdx)
+        {
+            ++length;
+        }
+
+        return length;
+    }
+
     void merge(size_t start, size_t end)
     {
         const auto startRoot(findRoot(start));
@@ -70,6 +115,8 @@ public:
         {
             m_components[startRoot].subtreeSize += 1;
         }
+
+        --m_numComponents;
     }
 private:
     struct UnionFindNode
@@ -86,4 +133,5 @@ private:
     };
 
     std::vector<UnionFindNode> m_components;
+    size_t m_numComponents;
 };
@@ -2,6 +2,9 @@
 
 #include <string>
 
+#include "SymbolTable.h"
+
+// A free-standing vertex id, as passed to AdjacencyList::addVertex and findVertex.
 class Vertex
 {
 public:
@@ -11,10 +14,31 @@ public:
 
     }
 
-    std::string getId() const
+    const std::string& getId() const
     {
         return m_id;
     }
 private:
     std::string m_id;
 };
+
+// A vertex as stored by a graph: the symbol of its id in the graph's SymbolTable.
+// The id is resolved through the graph; see AdjacencyList::getVertexId.
+class InternedVertex
+{
+public:
+    typedef SymbolTable::symbol_type symbol_type;
+
+    explicit InternedVertex(symbol_type symbol)
+        : m_symbol(symbol)
+    {
+
+    }
+
+    symbol_type getSymbol() const
+    {
+        return m_symbol;
+    }
+private:
+    symbol_type m_symbol;
+};
@@ -1,8 +1,11 @@
 #define BOOST_TEST_MODULE KruskalAlgorithm
 #include <boost/test/unit_test.hpp>
 #include <boost/timer/timer.hpp>
+#include <boost/type_traits/has_trivial_copy.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
 
 #include "AdjacencyList.h"
+#include "GraphGenerators.h"
 
 BOOST_AUTO_TEST_CASE(EmptyGraph)
 {
@@ -65,3 +68,287 @@ BOOST_AUTO_TEST_CASE(MspCutWikipedia)
     BOOST_CHECK(mst.findEdge("D", "E", 1).isValid());
     BOOST_CHECK(mst.findEdge("E", "F", 4).isValid());
 }
+
+BOOST_AUTO_TEST_CASE(SymbolTableInterning)
+{
+    SymbolTable symbols;
+
+    const auto a = symbols.intern("A");
+    const auto b = symbols.intern("B");
+    const auto empty = symbols.intern("");
+
+    BOOST_CHECK(a != b);
+    BOOST_CHECK_EQUAL(symbols.intern("A"), a);
+    BOOST_CHECK_EQUAL(symbols.find("B"), b);
+    BOOST_CHECK_EQUAL(symbols.find(""), empty);
+    BOOST_CHECK_EQUAL(symbols.find("C"), SymbolTable::invalidSymbol());
+    BOOST_CHECK_EQUAL(symbols.getString(a), "A");
+    BOOST_CHECK_EQUAL(symbols.size(), 3u);
+    BOOST_CHECK_THROW(symbols.getString(3), std::out_of_range);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        symbols.intern(std::to_string(i));
+    }
+
+    BOOST_CHECK_EQUAL(symbols.size(), 1003u);
+    BOOST_CHECK_EQUAL(symbols.find("A"), a);
+    BOOST_CHECK_EQUAL(symbols.getString(symbols.find("999")), "999");
+}
+
+BOOST_AUTO_TEST_CASE(VertexHandles)
+{
+    AdjacencyList::vertex_pointer danglingVertex;
+    BOOST_CHECK(!danglingVertex.isValid());
+
+    {
+        AdjacencyList graph;
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            graph.addVertex(std::to_string(i));
+        }
+
+        const auto v = graph.addVertex("500");
+        BOOST_CHECK_EQUAL(graph.getNumVertices(), 1000u);
+        BOOST_CHECK_EQUAL(v.getIndex(), 500u);
+        BOOST_CHECK_EQUAL(graph.getVertexId(v), "500");
+        BOOST_CHECK(!graph.findVertex("1000").isValid());
+
+        danglingVertex = v;
+        BOOST_CHECK(danglingVertex.isValid());
+    }
+
+    BOOST_CHECK(!danglingVertex.isValid());
+    BOOST_CHECK(danglingVertex.get() == nullptr);
+    BOOST_CHECK_THROW(danglingVertex.getIndex(), std::logic_error);
+
+    // A new graph may reuse the released registry slot; stale handles must stay invalid.
+    AdjacencyList graph;
+    for (int i = 0; i < 1000; ++i)
+    {
+        graph.addVertex(std::to_string(i));
+    }
+
+    BOOST_CHECK(!danglingVertex.isValid());
+    BOOST_CHECK(graph.findVertex("500").isValid());
+}
+
+BOOST_AUTO_TEST_CASE(HandlesSurviveGraphMove)
+{
+    BOOST_STATIC_ASSERT(boost::has_trivial_copy<AdjacencyList::vertex_pointer>::value);
+    BOOST_STATIC_ASSERT(boost::has_trivial_destructor<AdjacencyList::vertex_pointer>::value);
+
+    AdjacencyList graph;
+    const auto a = graph.addVertex("A");
+    const auto b = graph.addVertex("B");
+    const auto ab = graph.addEdge(a, b, 7);
+
+    const AdjacencyList movedGraph(std::move(graph));
+
+    BOOST_CHECK(a.isValid());
+    BOOST_CHECK(ab.isValid());
+    BOOST_CHECK_EQUAL(movedGraph.getVertexId(ab->getStart()), "A");
+    BOOST_CHECK_EQUAL(movedGraph.findEdge("A", "B", 7).getIndex(), ab.getIndex());
+}
+
+namespace
+{
+    class WeightSum
+    {
+    public:
+        WeightSum()
+            : m_total(0)
+        {
+
+        }
+
+        void operator()(const AdjacencyList::edge_pointer& edgePtr)
+        {
+            m_total += edgePtr->getWeight();
+        }
+
+        size_t getTotal() const
+        {
+            return m_total;
+        }
+    private:
+        size_t m_total;
+    };
+}
+
+BOOST_AUTO_TEST_CASE(MstEdgeSinks)
+{
+    AdjacencyList graph;
+
+    const auto a = graph.addVertex("A");
+    const auto b = graph.addVertex("B");
+    const auto c = graph.addVertex("C");
+    const auto d = graph.addVertex("D");
+
+    const auto ab = graph.addEdge(a, b, 1);
+    graph.addEdge(a, c, 4);
+    const auto bc = graph.addEdge(b, c, 2);
+    graph.addEdge(b, d, 6);
+    const auto cd = graph.addEdge(c, d, 3);
+
+    size_t totalWeight = 0;
+    graph.kruskal([&totalWeight](const AdjacencyList::edge_pointer& e) { totalWeight += e->getWeight(); });
+    BOOST_CHECK_EQUAL(totalWeight, 6u);
+    BOOST_CHECK_EQUAL(graph.kruskal(WeightSum()).getTotal(), 6u);
+
+    const auto edgeIndices(graph.kruskalEdgeIndices());
+    BOOST_REQUIRE_EQUAL(edgeIndices.size(), 3u);
+    BOOST_CHECK_EQUAL(edgeIndices[0], ab.getIndex());
+    BOOST_CHECK_EQUAL(edgeIndices[1], bc.getIndex());
+    BOOST_CHECK_EQUAL(edgeIndices[2], cd.getIndex());
+
+    size_t writtenIndices[4] = {};
+    BOOST_CHECK(graph.kruskalEdgeIndices(writtenIndices) == writtenIndices + 3);
+    BOOST_CHECK_EQUAL_COLLECTIONS(begin(edgeIndices), end(edgeIndices), writtenIndices, writtenIndices + 3);
+
+    BOOST_CHECK(AdjacencyList().kruskalEdgeIndices().empty());
+}
+
+BOOST_AUTO_TEST_CASE(SingleLinkageClustering)
+{
+    AdjacencyList graph;
+
+    const auto a = graph.addVertex("A");
+    const auto b = graph.addVertex("B");
+    const auto c = graph.addVertex("C");
+    const auto d = graph.addVertex("D");
+    const auto e = graph.addVertex("E");
+
+    graph.addEdge(a, b, 1);
+    graph.addEdge(b, c, 2);
+    graph.addEdge(a, c, 3);
+    graph.addEdge(d, e, 4);
+    graph.addEdge(c, d, 10);
+
+    const auto twoClusters(graph.kruskalForest(2));
+    BOOST_CHECK_EQUAL(twoClusters.numComponents, 2u);
+    BOOST_CHECK(twoClusters.dendrogram.empty());
+
+    const size_t expectedLabels[] = { 0, 0, 0, 1, 1 };
+    BOOST_CHECK_EQUAL_COLLECTIONS(begin(twoClusters.labels), end(twoClusters.labels),
+                                  std::begin(expectedLabels), std::end(expectedLabels));
+
+    const auto withinThree(graph.kruskalForest(1, 3));
+    BOOST_CHECK_EQUAL(withinThree.numComponents, 3u);
+    const size_t expectedThresholdLabels[] = { 0, 0, 0, 1, 2 };
+    BOOST_CHECK_EQUAL_COLLECTIONS(begin(withinThree.labels), end(withinThree.labels),
+                                  std::begin(expectedThresholdLabels), std::end(expectedThresholdLabels));
+
+    const auto tree(graph.kruskalForest(1, std::numeric_limits<size_t>::max(), true));
+    BOOST_CHECK_EQUAL(tree.numComponents, 1u);
+    BOOST_REQUIRE_EQUAL(tree.dendrogram.size(), 4u);
+
+    // Zero clusters means the same as one: the scan stops once the tree is
+    // complete, before reaching an edge whose endpoints cannot be resolved.
+    const AdjacencyList::edge_type unreachable(AdjacencyList::vertex_pointer(), AdjacencyList::vertex_pointer(), 100);
+    std::vector<const AdjacencyList::edge_type*> edges(1, &unreachable);
+    for (const auto& edgePtr : graph.getEdgePointers())
+    {
+        edges.push_back(edgePtr.get());
+    }
+
+    const auto zeroClusters(kruskalForest(edges, graph.getNumVertices(), 0));
+    BOOST_CHECK_EQUAL(zeroClusters.numComponents, 1u);
+    BOOST_CHECK_EQUAL(graph.kruskalForest(0).numComponents, 1u);
+
+    // Clusters 5 = {A, B}, 6 = {A, B, C}, 7 = {D, E}
+    BOOST_CHECK_EQUAL(tree.dendrogram[0].weight, 1u);
+    BOOST_CHECK_EQUAL(tree.dendrogram[0].size, 2u);
+    BOOST_CHECK_EQUAL(std::min(tree.dendrogram[1].left, tree.dendrogram[1].right), 2u);
+    BOOST_CHECK_EQUAL(std::max(tree.dendrogram[1].left, tree.dendrogram[1].right), 5u);
+    BOOST_CHECK_EQUAL(tree.dendrogram[2].weight, 4u);
+    BOOST_CHECK_EQUAL(std::min(tree.dendrogram[3].left, tree.dendrogram[3].right), 6u);
+    BOOST_CHECK_EQUAL(std::max(tree.dendrogram[3].left, tree.dendrogram[3].right), 7u);
+    BOOST_CHECK_EQUAL(tree.dendrogram[3].weight, 10u);
+    BOOST_CHECK_EQUAL(tree.dendrogram[3].size, 5u);
+}
+
+BOOST_AUTO_TEST_CASE(SyntheticGenerators)
+{
+    const auto grid(generateGrid(4, 3, 1));
+    BOOST_CHECK_EQUAL(grid.numVertices, 12u);
+    BOOST_CHECK_EQUAL(grid.edges.size(), 17u);
+
+    const auto complete(generateComplete(10, 1));
+    BOOST_CHECK_EQUAL(complete.edges.size(), 45u);
+
+    const auto erdosRenyi(generateErdosRenyi(100, 300, 42));
+    BOOST_CHECK_EQUAL(erdosRenyi.edges.size(), 300u);
+    BOOST_CHECK_EQUAL(generateErdosRenyi(5, 100, 42).edges.size(), 10u);
+
+    const auto rmat(generateRmat(8, 500, 42));
+    BOOST_CHECK_EQUAL(rmat.numVertices, 256u);
+    BOOST_CHECK(rmat.edges.size() <= 500u);
+
+    const auto sameSeed(generateErdosRenyi(100, 300, 42));
+    BOOST_CHECK(std::equal(begin(erdosRenyi.edges), end(erdosRenyi.edges), begin(sameSeed.edges),
+                           [](const GeneratedEdge& lhs, const GeneratedEdge& rhs)
+                           {
+                               return lhs.start == rhs.start && lhs.end == rhs.end && lhs.weight == rhs.weight;
+                           }));
+
+    // A grid is connected, so its spanning tree touches every vertex.
+    AdjacencyList graph;
+    for (size_t vertexIdx = 0; vertexIdx < grid.numVertices; ++vertexIdx)
+    {
+        graph.addVertex(std::to_string(vertexIdx));
+    }
+
+    for (const auto& edge : grid.edges)
+    {
+        graph.appendEdge(graph.findVertex(std::to_string(edge.start)), graph.findVertex(std::to_string(edge.end)), edge.weight);
+    }
+
+    BOOST_CHECK_EQUAL(graph.kruskalEdgeIndices().size(), grid.numVertices - 1);
+    BOOST_CHECK_EQUAL(graph.kruskalForest(1).numComponents, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(MstSymbolTableIsolation)
+{
+    AdjacencyList graph;
+    graph.addEdge(graph.addVertex(Vertex("A")), graph.addVertex(Vertex("B")), 1);
+
+    auto mst(graph.kruskal());
+    BOOST_CHECK(mst.getSymbolTable() == graph.getSymbolTable());
+
+    const auto x = mst.addVertex(Vertex("X"));
+    BOOST_CHECK(mst.getSymbolTable() != graph.getSymbolTable());
+    BOOST_CHECK_EQUAL(graph.getSymbolTable()->find("X"), SymbolTable::invalidSymbol());
+    BOOST_CHECK(!graph.findVertex("X").isValid());
+
+    BOOST_CHECK(mst.findVertex(Vertex("A")).isValid());
+    BOOST_CHECK(mst.findEdge(mst.findVertex("A"), mst.findVertex("B"), 1).isValid());
+    BOOST_CHECK_EQUAL(mst.getVertexId(x), "X");
+}
+
+BOOST_AUTO_TEST_CASE(CopiedGraphOwnsItsElements)
+{
+    std::unique_ptr<AdjacencyList> graph(new AdjacencyList);
+    const auto a = graph->addVertex("A");
+    const auto ab = graph->addEdge(a, graph->addVertex("B"), 2);
+
+    AdjacencyList copy(*graph);
+    copy.addEdge(copy.findVertex("A"), copy.addVertex("C"), 3);
+    graph.reset();
+
+    BOOST_CHECK(!a.isValid());
+    BOOST_CHECK(!ab.isValid());
+    BOOST_CHECK_EQUAL(copy.getNumVertices(), 3u);
+    BOOST_CHECK_EQUAL(copy.getNumEdges(), 2u);
+
+    const auto copiedEdge = copy.findEdge("A", "B", 2);
+    BOOST_REQUIRE(copiedEdge.isValid());
+    BOOST_CHECK_EQUAL(copy.getVertexId(copiedEdge->getStart()), "A");
+
+    AdjacencyList assigned;
+    assigned = copy;
+    assigned = AdjacencyList();
+    BOOST_CHECK_EQUAL(assigned.getNumVertices(), 0u);
+    BOOST_CHECK(copy.findEdge("A", "C", 3).isValid());
+}